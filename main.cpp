@@ -1,6 +1,11 @@
 #include <bits/stdc++.h>
 using namespace std;
 
+/// Number of filter bits reserved per key slot of a leaf and number of hash probes per key
+/// 10 bits per key with 3 probes keeps the false positive rate of a full leaf below 2%
+const int BLOOM_BITS_PER_KEY = 10;
+const int BLOOM_HASHES = 3;
+
 /// A class to create a node for the B+ tree with order `m`
 /// Each internal node will have a minimum of `ceil(m/2)` keys and a maximum of `(m-1)` keys
 /// Each leaf node will have a minimum of `ceil((m-1)/2)` keys and a maximum of `(m-1)` keys
@@ -11,16 +16,23 @@ class Node {
         vector<int> keys;
         vector<Node*> pointers;
         bool isLeaf;
+        /// Bloom filter over the keys of a leaf, consulted before the keys of the leaf are read
+        vector<bool> filter;
 
         Node(int order, bool leaf) {
             m = order;
             isLeaf = leaf;
             pointers.resize(m, NULL);
+            if (isLeaf)
+                filter.resize(max(1, m-1) * BLOOM_BITS_PER_KEY, false);
         }
 
         void insertKey(int key);
         bool isEmpty();
         bool isFull();
+        void addToFilter(int key);
+        bool mayContain(int key);
+        void rebuildFilter();
         void display();
 };
 
@@ -31,9 +43,18 @@ class BPlusTree {
         int m;
         Node* root;
 
-        BPlusTree(int order) {
+        /// Leaf filter metrics: lookups that reached a leaf, leaf reads avoided by a negative filter
+        /// answer and leaf reads where the filter answered "maybe" but the key was absent
+        bool useFilters;
+        long long filterProbes;
+        long long leafReadsAvoided;
+        long long falsePositives;
+
+        BPlusTree(int order, bool filters = true) {
             m = order;
             root = new Node(m, true);
+            useFilters = filters;
+            filterProbes = leafReadsAvoided = falsePositives = 0;
         }
 
         pair<Node*,Node*> search(int key);
@@ -44,6 +65,7 @@ class BPlusTree {
         void mergeInternal(Node* node);
         void deleteFromInternal(int key);
         void display();
+        void displayFilterStats();
 };
 
 /// Utility function to set all the values of `vec` to `NULL`
@@ -67,6 +89,38 @@ bool Node::isEmpty() {
 void Node::insertKey(int key) {
     keys.push_back(key);
     sort(keys.begin(), keys.end());
+    if (isLeaf)
+        addToFilter(key);
+}
+
+/// Utility function to compute the `i`th filter bit for a `key` using double hashing
+size_t filterIndex(int key, int i, size_t size) {
+    unsigned int h1 = (unsigned int)key * 0x9E3779B1u;
+    h1 ^= h1 >> 16;
+    unsigned int h2 = (unsigned int)key * 0x85EBCA77u;
+    h2 = (h2 ^ (h2 >> 13)) | 1;
+    return (h1 + (unsigned int)i * h2) % size;
+}
+
+/// Function to add a `key` to the Bloom filter of a leaf node
+void Node::addToFilter(int key) {
+    for (int i = 0; i < BLOOM_HASHES; i++)
+        filter[filterIndex(key, i, filter.size())] = true;
+}
+
+/// Function to check if a `key` may be present in a leaf node, a `false` result means it is surely absent
+bool Node::mayContain(int key) {
+    for (int i = 0; i < BLOOM_HASHES; i++)
+        if (!filter[filterIndex(key, i, filter.size())])
+            return false;
+    return true;
+}
+
+/// Function to rebuild the Bloom filter of a leaf node after its keys are moved or removed
+void Node::rebuildFilter() {
+    fill(filter.begin(), filter.end(), false);
+    for (auto key : keys)
+        addToFilter(key);
 }
 
 /// Function to display the node
@@ -120,6 +174,7 @@ void BPlusTree::insert(int key) {
                     keyValues.erase(keyValues.begin());
                 }
 
+                currentLeaf->rebuildFilter();
                 currentLeaf->pointers.back() = newLeaf;
                 newRoot->pointers[0] = currentLeaf;
                 newRoot->pointers[1] = newLeaf;
@@ -167,6 +222,7 @@ void BPlusTree::insert(int key) {
                     keyValues.erase(keyValues.begin());
                 }
 
+                currentLeaf->rebuildFilter();
                 currentLeaf->pointers.back() = newLeaf;
 
                 /// insert key into internal node 
@@ -285,10 +341,21 @@ pair<Node*,Node*> BPlusTree::search(int key) {
             currentLeaf = currentLeaf->pointers[currentLeaf->keys.size()];
         nxt:{}
     }
+
+    /// skip reading the leaf if its filter reports that the `key` is absent
+    if (useFilters) {
+        filterProbes++;
+        if (!currentLeaf->mayContain(key)) {
+            leafReadsAvoided++;
+            return {NULL,NULL};
+        }
+    }
     for (int i = 0; i < currentLeaf->keys.size(); i++) {
         if (key == currentLeaf->keys[i])
             return {parent,currentLeaf};
     }
+    if (useFilters)
+        falsePositives++;
     return {NULL,NULL};
 }
 
@@ -309,6 +376,7 @@ void BPlusTree::deleteKey(int key) {
     if (parent == NULL) {
         root->keys.erase(find(root->keys.begin(), root->keys.end(), key));
         sort(root->keys.begin(), root->keys.end());
+        root->rebuildFilter();
         return;
     }
 
@@ -316,6 +384,7 @@ void BPlusTree::deleteKey(int key) {
     if (currentLeaf->keys.size() > minimum) {
         currentLeaf->keys.erase(find(currentLeaf->keys.begin(), currentLeaf->keys.end(), key));
         sort(currentLeaf->keys.begin(), currentLeaf->keys.end());
+        currentLeaf->rebuildFilter();
         deleteFromInternal(key);
         return;
     }
@@ -345,6 +414,8 @@ void BPlusTree::deleteKey(int key) {
         leftSibling->keys.pop_back();
         currentLeaf->keys.insert(currentLeaf->keys.begin(), borrowKey);
         parent->keys[left] = borrowKey;
+        leftSibling->rebuildFilter();
+        currentLeaf->rebuildFilter();
     }
 
     /// borrow a key from the right sibling if possible
@@ -357,6 +428,8 @@ void BPlusTree::deleteKey(int key) {
         rightSibling->keys.erase(rightSibling->keys.begin());
         currentLeaf->keys.push_back(borrowKey);
         parent->keys[right-1] = rightSibling->keys[0];
+        rightSibling->rebuildFilter();
+        currentLeaf->rebuildFilter();
     }
 
     /// merge with left sibling if it exists
@@ -379,6 +452,7 @@ void BPlusTree::deleteKey(int key) {
             newLeaf->keys.push_back(k);
             sort(newLeaf->keys.begin(), newLeaf->keys.end());
         }
+        newLeaf->rebuildFilter();
 
         
         parent->pointers[left] = newLeaf;
@@ -417,6 +491,7 @@ void BPlusTree::deleteKey(int key) {
             newLeaf->keys.push_back(k);
             sort(newLeaf->keys.begin(), newLeaf->keys.end());
         }
+        newLeaf->rebuildFilter();
 
         parent->pointers[right-1] = newLeaf;
         for (int i = right; i < parent->keys.size(); i++) {
@@ -604,6 +679,17 @@ void BPlusTree::display() {
     }
 }
 
+/// Function to display the metrics of the leaf Bloom filters
+void BPlusTree::displayFilterStats() {
+    if (!useFilters) {
+        cout << "Leaf filters are disabled\n";
+        return;
+    }
+    cout << "Leaf filter probes: " << filterProbes << endl
+         << "Leaf reads avoided: " << leafReadsAvoided << endl
+         << "False positives: " << falsePositives << endl;
+}
+
 signed main() {
 
     cout << "Enter order of the B+ tree: ";
@@ -616,7 +702,8 @@ signed main() {
         cout << "1. Insert a key" << endl
              << "2. Delete a key" << endl
              << "3. Display the B+ tree" << endl
-             << "4. Exit the program" << endl;
+             << "4. Display leaf filter statistics" << endl
+             << "5. Exit the program" << endl;
 
         int option;
         cin >> option;
@@ -641,6 +728,11 @@ signed main() {
                 break;
 
             case 4:
+                cout << endl;
+                bp.displayFilterStats();
+                break;
+
+            case 5:
                 goto end;
                 break;
             